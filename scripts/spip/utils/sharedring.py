@@ -0,0 +1,64 @@
+##############################################################################
+#
+#     Copyright (C) 2016 by Andrew Jameson
+#     Licensed under the Academic Free License version 2.1
+#
+###############################################################################
+
+import mmap, os, struct
+
+# layout of the segment created by spip::SharedRing
+SEGMENT_FORMAT = "<8sIII44x"
+CONTROL_FORMAT = "<5Q24xQQ48xII56xII56x"
+READER_FORMAT = "<QI52x"
+MAX_READERS = 8
+SEGMENT_SIZE = struct.calcsize (SEGMENT_FORMAT)
+READER_SIZE = struct.calcsize (READER_FORMAT)
+CONTROL_SIZE = struct.calcsize (CONTROL_FORMAT) + MAX_READERS * READER_SIZE
+
+def getSharedRingPath (key):
+  return "/dev/shm/spip_ring_" + key
+
+# state of a native ring in the form of dada_dbmetric, returns
+# (hdr, dat) dicts of nbufs, full, clear, written and read, or None
+def readSharedRingState (key):
+
+  path = getSharedRingPath (key)
+  if not os.path.exists (path):
+    return None
+
+  fd = os.open (path, os.O_RDONLY)
+  try:
+    size = os.fstat (fd).st_size
+    if size < SEGMENT_SIZE + 2 * CONTROL_SIZE:
+      return None
+    buf = mmap.mmap (fd, SEGMENT_SIZE + 2 * CONTROL_SIZE, mmap.MAP_SHARED, mmap.PROT_READ)
+  finally:
+    os.close (fd)
+
+  try:
+    (magic, version, locked, writer) = struct.unpack_from (SEGMENT_FORMAT, buf, 0)
+    if magic != b"SPIPRING" or version != 2:
+      return None
+
+    rings = []
+    for iring in range(2):
+      offset = SEGMENT_SIZE + iring * CONTROL_SIZE
+      values = struct.unpack_from (CONTROL_FORMAT, buf, offset)
+      (nbufs, bufsz, nreaders) = values[0:3]
+      written = values[5]
+
+      # the slowest reader holds the buffers that are not yet cleared
+      read = written
+      offset += struct.calcsize (CONTROL_FORMAT)
+      for ireader in range(min (nreaders, MAX_READERS)):
+        (count, attached) = struct.unpack_from (READER_FORMAT, buf, offset + ireader * READER_SIZE)
+        read = min (read, count)
+
+      full = written - read
+      rings.append ({'nbufs':nbufs, 'full':full, 'clear':nbufs - full,
+                     'written':written, 'read':read})
+
+    return (rings[0], rings[1])
+  finally:
+    buf.close()
@@ -0,0 +1,68 @@
+##############################################################################
+#
+#     Copyright (C) 2015 by Andrew Jameson
+#     Licensed under the Academic Free License version 2.1
+#
+###############################################################################
+
+import mmap, os, struct
+from time import sleep
+
+# layout of the segment published by spip::UDPStatsSegment
+HEADER_FORMAT = "<8sIIQQQ24x"
+STREAM_FORMAT = "<9Q4d24x"
+HEADER_SIZE = struct.calcsize (HEADER_FORMAT)
+STREAM_SIZE = struct.calcsize (STREAM_FORMAT)
+
+STREAM_FIELDS = ["packets", "bytes", "bytes_dropped", "sleeps",
+                 "late_packets", "early_packets", "recv_calls",
+                 "boundary_wait_ns", "window_used", "bytes_per_second",
+                 "bytes_dropped_per_second", "packets_per_second",
+                 "sleeps_per_second"]
+
+def getUDPStatsPath (key):
+  return "/dev/shm/spip_udpstats_" + key
+
+# read a consistent snapshot of the UDP stats of the receiver writing to
+# the data block key, returns (utc_ns, [stream dicts]) or None
+def readUDPStats (key, max_tries=100):
+
+  path = getUDPStatsPath (key)
+  if not os.path.exists (path):
+    return None
+
+  fd = os.open (path, os.O_RDONLY)
+  try:
+    size = os.fstat (fd).st_size
+    if size < HEADER_SIZE:
+      return None
+    buf = mmap.mmap (fd, size, mmap.MAP_SHARED, mmap.PROT_READ)
+  finally:
+    os.close (fd)
+
+  try:
+    for i in range(max_tries):
+      (magic, version, nstreams, seq1, utc_ns, nsnapshots) = \
+        struct.unpack_from (HEADER_FORMAT, buf, 0)
+      if magic != b"SPIPSTAT" or version != 1:
+        return None
+
+      # a snapshot is being written
+      if seq1 % 2 == 1:
+        sleep (0.001)
+        continue
+
+      nstreams = min (nstreams, (size - HEADER_SIZE) // STREAM_SIZE)
+      streams = []
+      for istream in range(nstreams):
+        values = struct.unpack_from (STREAM_FORMAT, buf, HEADER_SIZE + istream * STREAM_SIZE)
+        streams.append (dict (zip (STREAM_FIELDS, values)))
+
+      # the snapshot changed while it was copied
+      (seq2,) = struct.unpack_from ("<Q", buf, 16)
+      if seq2 == seq1:
+        return (utc_ns, streams)
+
+    return None
+  finally:
+    buf.close()
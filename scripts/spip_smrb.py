@@ -12,7 +12,7 @@
 #   SMRBs destroyed upon exit
 #
 
-import threading, sys, traceback, socket, select
+import os, threading, sys, traceback, socket, select
 from time import sleep
 
 from json import dumps
@@ -21,6 +21,7 @@ from spip.daemons.bases import StreamBased
 from spip.daemons.daemon import Daemon
 from spip.log_socket import LogSocket
 from spip.utils.core import system
+from spip.utils.sharedring import readSharedRingState
 
 DAEMONIZE = True
 DL        = 1
@@ -117,6 +118,10 @@ class monThread (threading.Thread):
         del can_read[i]
 
   def getDBState (self, key):
+    state = readSharedRingState (key)
+    if state:
+      return 0, state[0], state[1]
+
     cmd = "dada_dbmetric -k " + key
     rval, lines = system (cmd, False)
     if rval == 0:
@@ -155,20 +160,28 @@ class SMRBDaemon(Daemon,StreamBased):
       bufsz = self.cfg["BLOCK_BUFSZ_" + db_id]
       nread = self.cfg["BLOCK_NREAD_" + db_id]
       page  = self.cfg["BLOCK_PAGE_" + db_id]
+      native = self.cfg.get("BLOCK_NATIVE_" + db_id, "false") == "true"
 
       # check if the datablock already exists
       cmd = "ipcs | grep 0x0000" + db_key + " | wc -l"
       rval, lines = self.system (cmd)
-      if rval == 0 and len(lines) == 1 and lines[0] == "1":
+      existed = rval == 0 and len(lines) == 1 and lines[0] == "1"
+      existed = existed or os.path.exists ("/dev/shm/spip_ring_" + db_key)
+      if existed:
         self.log (-1, "Data block with key " + db_key + " existed at launch")
-        cmd = "dada_db -k " + db_key + " -d"
+        cmd = "spip_dbcreate -k " + db_key + " -d"
         rval, lines = self.system (cmd)
         if rval != 0:
           self.log (-2, "Could not destroy existing datablock")
 
-      cmd = "dada_db -k " + db_key + " -n " + nbufs + " -b " + bufsz + " -r " + nread + " -c " + numa_node 
+      # buffers are bound to the stream's NUMA node, optionally on huge pages
+      cmd = "spip_dbcreate -k " + db_key + " -n " + nbufs + " -b " + bufsz + " -r " + nread + " -c " + numa_node 
       if page:
         cmd += " -p -l"
+      if self.cfg.get("BLOCK_HUGEPAGE_" + db_id, "false") == "true":
+        cmd += " -H"
+      if native:
+        cmd += " -N"
       self.log (1, cmd)
       rval, lines = self.system (cmd)
       db_keys.append(db_key)
@@ -181,7 +194,7 @@ class SMRBDaemon(Daemon,StreamBased):
       sleep(1)
 
     for db_key in db_keys:
-      cmd = "dada_db -k " + db_key + " -d"
+      cmd = "spip_dbcreate -k " + db_key + " -d"
       rval, lines = self.system (cmd)
 
     if mon_thread:
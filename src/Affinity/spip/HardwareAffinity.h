@@ -4,6 +4,8 @@
 
 #include "config.h"
 
+#include <cstddef>
+
 #ifdef HAVE_HWLOC
 #include <hwloc.h>
 #endif
@@ -24,6 +26,10 @@ namespace spip {
 
       void bind_to_memory (int);
 
+      //! bind the pages of an area of memory to a NUMA node, returns false
+      //! if the binding failed or hwloc is not available
+      bool bind_area_to_numa_node (void * addr, size_t len, int node);
+
     private:
 
       void bind_to_cpu_core (int core, int flags);
@@ -5,6 +5,8 @@
 #include "ipcio.h"
 #include "ipcbuf.h"
 
+#include "spip/SharedRing.h"
+
 #include <cstddef>
 #include <string>
 
@@ -36,6 +38,8 @@ namespace spip
 
       const uint64_t get_header_bufsz () { return header_bufsz; };
 
+      uint64_t get_data_nbufs () { return data_nbufs; };
+
       inline const bool is_block_open () { return block_open; };
 
       inline const bool is_block_full () { return (curr_buf_bytes == data_bufsz); };
@@ -48,6 +52,9 @@ namespace spip
 
       ipcio_t * data_block;
 
+      //! native ring of the key, NULL if the key is a PSRDada block
+      SharedRing * ring;
+
       bool connected;
 
       bool locked;
@@ -58,6 +65,8 @@ namespace spip
 
       uint64_t data_bufsz;
 
+      uint64_t data_nbufs;
+
       void * curr_buf;
 
       uint64_t curr_buf_id;
@@ -0,0 +1,100 @@
+
+#ifndef __DataBlockCreate_h
+#define __DataBlockCreate_h
+
+#include "ipcbuf.h"
+
+#include "spip/HardwareAffinity.h"
+
+#include <inttypes.h>
+#include <string>
+
+namespace spip
+{
+  //! Creates and destroys the shared memory ring of a PSRDada data block,
+  //! as dada_db does, with control over the placement of the data
+  //! buffers: bound to a NUMA node, backed by 2 MiB huge pages, locked
+  //! in memory and pre-faulted, so that the capture threads do not take
+  //! page faults, TLB misses or remote memory accesses when they first
+  //! write to each buffer. The block may instead be created as a native
+  //! SharedRing, which the DataBlock classes use in place of PSRDada
+  class DataBlockCreate
+  {
+    public:
+
+      DataBlockCreate (const char * key);
+
+      ~DataBlockCreate ();
+
+      void set_data_bufs (uint64_t nbufs, uint64_t bufsz);
+
+      void set_header_bufs (uint64_t nbufs, uint64_t bufsz);
+
+      void set_nreaders (unsigned n) { nreaders = n; };
+
+      //! NUMA node to which the data buffers are bound, -1 for none
+      void set_numa_node (int node) { numa_node = node; };
+
+      //! back the data buffers with transparent huge pages, the data
+      //! buffers are then faulted in on creation
+      void set_hugepages (bool enable) { hugepages = enable; };
+
+      //! lock the buffers in memory with SHM_LOCK
+      void set_lock (bool enable) { lock = enable; };
+
+      //! fault in every page of the buffers after creation
+      void set_prefault (bool enable) { prefault = enable; };
+
+      //! create a native SharedRing rather than a PSRDada block
+      void set_native (bool enable) { native = enable; };
+
+      void set_verbose (int v) { verbose = v; };
+
+      //! create the header and data blocks
+      void create ();
+
+      //! destroy the header and data blocks, or the native ring of the key
+      void destroy ();
+
+    private:
+
+      void create_native ();
+
+      //! warn if the kernel will not back shared memory with huge pages
+      void warn_hugepages ();
+
+      //! apply the placement options to a page aligned area, huge pages
+      //! are only used for the data block
+      void place (HardwareAffinity& hw_affinity, char * buf, uint64_t bufsz, bool data);
+
+      key_t data_block_key;
+
+      key_t header_block_key;
+
+      uint64_t data_nbufs;
+
+      uint64_t data_bufsz;
+
+      uint64_t header_nbufs;
+
+      uint64_t header_bufsz;
+
+      unsigned nreaders;
+
+      int numa_node;
+
+      bool hugepages;
+
+      bool lock;
+
+      bool prefault;
+
+      bool native;
+
+      int verbose;
+
+  };
+
+}
+
+#endif
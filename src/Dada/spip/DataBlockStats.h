@@ -33,6 +33,9 @@ namespace spip {
 
       void set_verbosity (bool v) { verbose = v; };
 
+      //! analyse the first 1/n of each block, STATS_SUBSET in the config
+      void set_subset (unsigned n);
+
       void start_control_thread (int port);
 
       void stop_control_thread ();
@@ -61,8 +64,6 @@ namespace spip {
 
       DataBlockView * db;
 
-      char * buffer;
-
       pthread_t control_thread_id;
 
       int control_port;
@@ -77,6 +78,10 @@ namespace spip {
 
       uint64_t bufsz;
 
+      uint64_t resolution;
+
+      unsigned subset;
+
       unsigned nchan;
 
       unsigned ndim;
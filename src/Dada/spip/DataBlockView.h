@@ -35,10 +35,36 @@ namespace spip {
 
       size_t seek (int64_t offset, int whence);
 
+      //! pin the most recently completed buffer in place, waiting for one
+      //! newer than the previous snapshot. Returns a pointer into the ring
+      //! and sets bytes, or returns NULL at end of data
+      const char * open_snapshot (uint64_t * bytes);
+
+      //! release the snapshot, false if the writer may have reused the
+      //! buffer while it was pinned, in which case anything computed from
+      //! it must be discarded. On PSRDada, which does not record the
+      //! writer's lookahead, a snapshot is only known intact while some
+      //! reader has not yet cleared the buffer
+      bool close_snapshot ();
+
     protected:
 
     private:
 
+      //! next buffer to be viewed
+      uint64_t view_count;
+
+      //! buffer pinned by open_snapshot
+      uint64_t snapshot_count;
+
+      bool snapshot_open;
+
+      //! PSRDada transfer being viewed
+      uint64_t view_xfer;
+
+      //! the last buffer viewed on a native ring was the end of data
+      bool view_ended;
+
   };
 
 }
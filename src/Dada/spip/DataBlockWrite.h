@@ -45,6 +45,11 @@ namespace spip {
 
       void zero_next_block ();
 
+      //! return the k'th buffer after the open block, or NULL if the
+      //! readers have not yet cleared it. Writing ahead of the open block
+      //! is only valid for buffers returned by this method
+      void * get_lookahead_block (unsigned k);
+
     protected:
 
     private:
@@ -0,0 +1,203 @@
+
+#ifndef __SharedRing_h
+#define __SharedRing_h
+
+#include <inttypes.h>
+#include <sys/types.h>
+#include <string>
+
+#define SHARED_RING_MAGIC "SPIPRING"
+#define SHARED_RING_VERSION 2
+
+// reader slots in the segment, each reader clears every buffer
+#define SHARED_RING_MAX_READERS 8
+
+// flag of the buffer published by the writer at end of data
+#define SHARED_RING_EOD 1
+
+namespace spip {
+
+  //! header of the segment, followed by the header and data rings
+  typedef struct {
+    char magic[8];
+    uint32_t version;
+    //! non-zero if each process locks its mapping in memory
+    uint32_t locked;
+    //! pid of the process locked as writer, 0 if none
+    uint32_t writer;
+    char pad[44];
+  } shared_ring_segment_t;
+
+  //! count of the buffers cleared by a reader
+  typedef struct {
+    uint64_t read_count;
+    uint32_t attached;
+    char pad[52];
+  } shared_ring_reader_t;
+
+  //! bytes and flags of a published buffer
+  typedef struct {
+    uint64_t bytes;
+    uint64_t flags;
+  } shared_ring_buffer_t;
+
+  //! state of one ring, the counts are shared by the processes and only
+  //! increase, buffer n is held in slot n % nbufs
+  typedef struct {
+    uint64_t nbufs;
+    uint64_t bufsz;
+    uint64_t nreaders;
+    //! offsets of the buffer descriptors and of slot 0 in the segment
+    uint64_t desc_offset;
+    uint64_t buf_offset;
+    char pad0[24];
+    //! buffers published by the writer
+    uint64_t write_count;
+    //! one more than the highest buffer the writer has opened or
+    //! looked ahead to, the writer may be filling any slot below it
+    uint64_t reserve_count;
+    char pad1[48];
+    //! incremented as each buffer is published, readers sleep on it
+    uint32_t write_futex;
+    uint32_t write_waiters;
+    char pad2[56];
+    //! incremented as each buffer is cleared, the writer sleeps on it
+    uint32_t clear_futex;
+    uint32_t clear_waiters;
+    char pad3[56];
+    shared_ring_reader_t readers[SHARED_RING_MAX_READERS];
+  } shared_ring_control_t;
+
+  //! Ring of header and data buffers in a POSIX shared memory segment,
+  //! the native alternative to a PSRDada header and data block. The
+  //! writer and readers exchange buffers through atomic counts in the
+  //! segment and make a futex system call only to sleep when the ring
+  //! is full or empty, or to wake a process that is sleeping.
+  //!
+  //! Every buffer is cleared by each of the nreaders readers before the
+  //! writer reuses it. Viewers read published buffers without clearing
+  //! them and so may be lapped by the writer
+  class SharedRing {
+
+    public:
+
+      enum Ring { Header = 0, Data = 1 };
+
+      SharedRing (key_t key);
+
+      ~SharedRing ();
+
+      //! name of the segment of the data block key
+      static std::string get_name (key_t key);
+
+      //! true if a native ring has been created for the data block key
+      static bool exists (key_t key);
+
+      //! create and connect to the segment
+      void create (uint64_t header_nbufs, uint64_t header_bufsz,
+                   uint64_t data_nbufs, uint64_t data_bufsz,
+                   unsigned nreaders, bool lock);
+
+      void connect ();
+
+      void disconnect ();
+
+      //! unlink the segment, mapped processes keep their mapping
+      void destroy ();
+
+      uint64_t get_nbufs (Ring r) { return ctrl[r]->nbufs; };
+
+      uint64_t get_bufsz (Ring r) { return ctrl[r]->bufsz; };
+
+      //! slot that holds buffer count
+      char * get_buffer (Ring r, uint64_t count);
+
+      const shared_ring_buffer_t * get_desc (Ring r, uint64_t count);
+
+      uint64_t get_write_count (Ring r);
+
+      //! fault in every page of the data buffers
+      void page ();
+
+      void lock_write ();
+
+      void unlock_write ();
+
+      //! wait until the next buffer has been cleared by every reader
+      char * open_write (Ring r);
+
+      //! publish the open buffer
+      void close_write (Ring r, uint64_t bytes, uint64_t flags);
+
+      //! set the bytes of the open buffer without publishing it
+      void update_write (Ring r, uint64_t bytes);
+
+      //! k'th buffer after the next to be published, NULL if it has not
+      //! been cleared by every reader
+      char * get_lookahead (Ring r, unsigned k);
+
+      //! copy bytes into the data buffers, publishing each as it fills
+      ssize_t write (const char * ptr, size_t bytes);
+
+      //! start of data, the next mark_eod ends it
+      void start_data () { writing = true; };
+
+      //! publish any partly written data buffer and then the end of data,
+      //! if data has been started
+      void mark_eod ();
+
+      //! attach to a free reader slot
+      void lock_read ();
+
+      void unlock_read ();
+
+      //! wait until the next buffer of this reader has been published
+      char * open_read (Ring r, uint64_t * bytes, uint64_t * flags);
+
+      //! clear the buffer returned by open_read
+      void close_read (Ring r);
+
+      uint64_t get_read_count (Ring r);
+
+      //! wait until buffer count has been published
+      void wait_write_count (Ring r, uint64_t count);
+
+      //! true if the writer may be reusing the slot of buffer count,
+      //! including slots held through get_lookahead. Call after reading
+      //! from the slot, to test whether what was read is intact
+      bool is_lapped (Ring r, uint64_t count);
+
+    private:
+
+      //! record that the writer may fill buffer count from now on
+      void reserve (Ring r, uint64_t count);
+
+      //! lowest count of the buffers cleared by each reader
+      uint64_t get_min_read (Ring r);
+
+      std::string name;
+
+      size_t size;
+
+      shared_ring_segment_t * segment;
+
+      shared_ring_control_t * ctrl[2];
+
+      //! reader slot attached by this process, -1 if none
+      int reader;
+
+      bool writer;
+
+      //! data has been started and not yet ended
+      bool writing;
+
+      //! data buffer partly filled by write
+      char * write_buf;
+
+      uint64_t write_offset;
+
+  };
+
+}
+
+#endif
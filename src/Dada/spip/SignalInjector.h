@@ -0,0 +1,125 @@
+
+#ifndef __SignalInjector_h
+#define __SignalInjector_h
+
+#include <cstdlib>
+#include <inttypes.h>
+#include <vector>
+
+namespace spip {
+
+  //! Injects simulated signals into blocks of quantised noise ordered by
+  //! time, channel and then polarisation (TF or TFP). The signals are
+  //! configured by optional header keys:
+  //!
+  //!   SIM_PULSAR_PERIOD  period of a dispersed pulsar [s]
+  //!   SIM_PULSAR_DM      dispersion measure of the pulsar [pc/cm^3]
+  //!   SIM_PULSAR_WIDTH   width of each pulse [s, default 5% of period]
+  //!   SIM_PULSAR_SNR     S/N of each pulse detected over the whole band
+  //!   SIM_TONE_FREQ      frequency of a CW tone [MHz]
+  //!   SIM_TONE_SNR       power of the tone relative to the noise
+  //!   SIM_RFI_RATE       broadband bursts of RFI per second
+  //!   SIM_RFI_WIDTH      width of each burst [s, default 1 ms]
+  //!   SIM_RFI_SNR        S/N of each burst detected over the whole band
+  //!   SIM_THREADS        threads injecting each block [default 1]
+  //!
+  //! Pulses and bursts are noise-like, scaling the power of the samples
+  //! they cover. Dispersion delays are relative to the top of the band
+  //! given by FREQ, BW and NCHAN
+  class SignalInjector {
+
+    public:
+
+      SignalInjector ();
+
+      ~SignalInjector ();
+
+      //! read the band and the signals from the header
+      void configure (const char * config);
+
+      //! rms of the noise in quantisation levels, to which S/N are relative
+      void set_noise_rms (double rms) { noise_rms = rms; };
+
+      //! true if any signal is configured
+      bool enabled () { return pulsar_snr > 0 || tone_snr > 0 || rfi_snr > 0; };
+
+      //! inject the signals into the block, which starts at byte_offset
+      //! bytes from the start of the observation
+      void inject (char * block, uint64_t nbytes, uint64_t byte_offset);
+
+    private:
+
+      typedef struct {
+        SignalInjector * obj;
+        char * block;
+        uint64_t isamp_block;
+        uint64_t isamp_start;
+        uint64_t isamp_end;
+      } inject_thread_arg_t;
+
+      static void * inject_thread_wrapper (void * arg)
+      {
+        inject_thread_arg_t * inject_arg = (inject_thread_arg_t *) arg;
+        inject_arg->obj->inject_range (inject_arg->block, inject_arg->isamp_block,
+                                       inject_arg->isamp_start, inject_arg->isamp_end);
+        return NULL;
+      }
+
+      //! inject the time samples [isamp_start, isamp_end) of the block
+      //! that starts at time sample isamp_block
+      void inject_range (char * block, uint64_t isamp_block,
+                         uint64_t isamp_start, uint64_t isamp_end);
+
+      template <typename T>
+      void inject_samples (T * block, uint64_t isamp_block,
+                           uint64_t isamp_start, uint64_t isamp_end);
+
+      unsigned nchan;
+
+      unsigned npol;
+
+      unsigned ndim;
+
+      unsigned nbit;
+
+      //! sampling interval [s]
+      double tsamp;
+
+      //! centre frequency of each channel [MHz]
+      std::vector<double> chan_freqs;
+
+      //! bytes of one time sample of all channels and polarisations
+      uint64_t bytes_per_sample;
+
+      double noise_rms;
+
+      double pulsar_period;
+
+      double pulsar_dm;
+
+      double pulsar_width;
+
+      double pulsar_snr;
+
+      //! dispersion delay of each channel [samples]
+      std::vector<int64_t> pulsar_delays;
+
+      double tone_freq;
+
+      double tone_snr;
+
+      unsigned tone_chan;
+
+      double rfi_rate;
+
+      double rfi_width;
+
+      double rfi_snr;
+
+      unsigned nthreads;
+
+  };
+
+}
+
+#endif
@@ -5,9 +5,11 @@
 #include "config.h"
 
 #include "spip/AsciiHeader.h"
+#include "spip/Pacer.h"
 #include "spip/UDPFormat.h"
 #include "spip/UDPStats.h"
 #include "spip/DataBlockWrite.h"
+#include "spip/SignalInjector.h"
 
 #include <iostream>
 #include <cstdlib>
@@ -75,6 +77,12 @@ namespace spip {
 
       UDPFormat * format;
 
+      //! signals added to the noise of each block
+      SignalInjector injector;
+
+      //! paces blocks to bytes_per_second
+      Pacer pacer;
+
       UDPStats * stats;
 
       pthread_t stats_thread_id;
@@ -107,6 +115,9 @@ namespace spip {
 
       float tsamp;
 
+      //! rms of the noise in quantisation levels, 0 for the default of nbit
+      double noise_rms;
+
       double bits_per_second;
 
       double bytes_per_second;
@@ -47,6 +47,8 @@ namespace spip {
       inline int64_t decode_packet (char * buf, unsigned *payload_size);
       inline int insert_last_packet (char * buf);
 
+      void decode_batch (char ** packets, unsigned npackets, int64_t * offsets, unsigned * payload_sizes);
+
       int64_t decode_packet_seq (char* buf);
 
       void print_packet_header ();
@@ -84,6 +86,12 @@ namespace spip {
       bool started;
   };
 
+  template <>
+  struct UDPFormatLayout<UDPFormatBPSR> {
+    static const unsigned header_size = 8;
+    static const unsigned data_size = 4096;
+  };
+
 
 }
 
@@ -14,6 +14,9 @@
 
 #include <cstring>
 
+// number of heap_cnt to byte offset mappings retained while decoding
+#define UDP_FORMAT_MEERKAT_SPEAD_HEAP_CACHE 4
+
 static uint16_t magic_version = 0x5304;  // 0x53 is the magic, 4 is the version
 
 namespace spip {
@@ -51,9 +54,12 @@ namespace spip {
       inline void encode_header (char * buf);
 
       void decode_spead (char * buf);
-      inline int64_t decode_packet (char * buf, unsigned *payload_size);
+      int64_t decode_packet (char * buf, unsigned *payload_size);
       inline int insert_last_packet (char * buf);
 
+      void decode_batch (char ** packets, unsigned npackets, int64_t * offsets, unsigned * payload_sizes);
+      void insert_batch (char ** packets, unsigned npackets, char ** dests, const unsigned * payload_sizes);
+
       void print_packet_header ();
       void print_packet_timestamp ();
       bool check_stream_stop ();
@@ -70,8 +76,55 @@ namespace spip {
 
     private:
 
+      //! decode a packet with the layout learned from the stream, returns
+      //! false if the packet does not match the layout
+      inline bool decode_fast (const char * buf);
+
+      //! learn the positions of the items in a decoded F-engine packet
+      void learn_layout (const char * buf);
+
+      //! byte offset of the heap starting at the ADC sample, -1 if it
+      //! pre-dates the observation or is not aligned to a heap
+      inline int64_t get_heap_offset (int64_t adc_sample);
+
+      //! map the heap of a data packet that is not in the cache
+      int64_t decode_new_heap ();
+
+      //! forget the heap offsets of a previous observation
+      void clear_heap_cache ();
+
       spead2::recv::packet_header header;
 
+      //! the layout of the F-engine packets has been learned
+      bool layout_valid;
+
+      //! first 8 bytes of each packet: SPEAD magic, version, widths and n_items
+      uint64_t layout_word;
+
+      //! immediate flag and item ID of the timestamp item
+      uint64_t layout_timestamp_id;
+
+      //! index of each item pointer used in decoding
+      unsigned item_heap_cnt;
+
+      unsigned item_heap_length;
+
+      unsigned item_payload_offset;
+
+      unsigned item_payload_length;
+
+      unsigned item_timestamp;
+
+      //! values of the generic decoder for the learned layout
+      int layout_n_items;
+
+      unsigned layout_pointers_offset;
+
+      unsigned layout_payload_offset;
+
+      //! timestamp of the last decoded packet
+      int64_t curr_timestamp;
+
       time_t adc_sync_time;
 
       uint64_t adc_sample_rate;
@@ -100,11 +153,31 @@ namespace spip {
 
       unsigned pkts_per_heap;
 
+      //! a heap_cnt and the byte offset of its heap in the stream
+      typedef struct {
+        int64_t heap_cnt;
+        int64_t offset;
+      } heap_map_entry_t;
+
+      //! recently decoded heaps, so that the interleaved heaps of several
+      //! F-engines are each mapped once
+      heap_map_entry_t heap_cache[UDP_FORMAT_MEERKAT_SPEAD_HEAP_CACHE];
+
+      //! entry replaced by the next new heap
+      unsigned heap_cache_next;
+
+      //! heap of the last decoded packet and its byte offset
       int64_t curr_heap_cnt;
 
-      uint64_t curr_sample_number;
+      int64_t curr_heap_offset;
 
-      uint64_t curr_heap_offset;
+      //! log2 of adc_samples_per_heap
+      unsigned adc_samples_per_heap_shift;
+
+      //! bytes between the offsets of consecutive heaps in the stream
+      uint64_t heap_stride;
+
+      uint64_t curr_sample_number;
 
       uint64_t curr_heap_number;
 
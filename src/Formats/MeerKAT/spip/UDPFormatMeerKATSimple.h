@@ -90,6 +90,8 @@ namespace spip {
 
       inline void gen_packet (char * buf, size_t bufsz);
 
+      inline void patch_packet (char * buf);
+
       // accessor methods for header params
       void set_seq_num (uint64_t seq_num) { header.seq_number = seq_num; };
       void set_int_sec (uint32_t int_sec) { header.integer_seconds = int_sec; };
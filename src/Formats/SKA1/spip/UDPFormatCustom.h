@@ -81,6 +81,8 @@ namespace spip {
       inline int64_t decode_packet (char * buf, unsigned * payload_size);
       inline int insert_last_packet (char * buf);
 
+      void decode_batch (char ** packets, unsigned npackets, int64_t * offsets, unsigned * payload_sizes);
+
       inline int check_packet ();
       inline int insert_packet (char * buf, char * pkt, uint64_t start_samp, uint64_t next_samp);
 
@@ -88,6 +90,8 @@ namespace spip {
 
       inline void gen_packet (char * buf, size_t bufsz);
 
+      inline void patch_packet (char * buf);
+
       // accessor methods for header params
       void set_seq_num (uint64_t seq_num) { header.seq_number = seq_num; };
       void set_int_sec (uint32_t int_sec) { header.integer_seconds = int_sec; };
@@ -120,6 +124,12 @@ namespace spip {
 
   };
 
+  template <>
+  struct UDPFormatLayout<UDPFormatCustom> {
+    static const unsigned header_size = sizeof(ska1_custom_udp_header_t);
+    static const unsigned data_size = UDP_FORMAT_CUSTOM_PACKET_NSAMP * UDP_FORMAT_CUSTOM_NDIM * UDP_FORMAT_CUSTOM_NPOL;
+  };
+
 }
 
 #endif
@@ -50,6 +50,8 @@ namespace spip {
 
       inline int insert_last_packet (char * buf);
 
+      void decode_batch (char ** packets, unsigned npackets, int64_t * offsets, unsigned * payload_sizes);
+
       void print_packet_header ();
 
       inline void gen_packet (char * buf, size_t bufsz);
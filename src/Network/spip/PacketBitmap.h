@@ -0,0 +1,70 @@
+#ifndef __PacketBitmap_h
+#define __PacketBitmap_h
+
+#include <cstddef>
+#include <inttypes.h>
+
+namespace spip {
+
+  //! Validity bitmap of the packets in one data block buffer, bit i is set
+  //! once the payload at [i*packet_size, (i+1)*packet_size) has been written
+  class PacketBitmap {
+
+    public:
+
+      PacketBitmap (uint64_t block_size, unsigned packet_size);
+
+      ~PacketBitmap ();
+
+      //! mark every packet as missing
+      void reset ();
+
+      //! mark the packet at the byte offset within the block as received
+      inline void set (uint64_t byte_offset)
+      {
+        const uint64_t ipacket = byte_offset / packet_size;
+        bits[ipacket >> 6] |= uint64_t(1) << (ipacket & 63);
+      };
+
+      //! as set, for bitmaps written by multiple capture threads
+      inline void set_atomic (uint64_t byte_offset)
+      {
+        const uint64_t ipacket = byte_offset / packet_size;
+        __atomic_fetch_or (&bits[ipacket >> 6], uint64_t(1) << (ipacket & 63), __ATOMIC_RELAXED);
+      };
+
+      //! number of packets received
+      uint64_t count ();
+
+      //! zero the payload of each missing packet in the block
+      void zero_missing (char * block);
+
+      uint64_t get_npackets () { return npackets; };
+
+      unsigned get_packet_size () { return packet_size; };
+
+      const uint64_t * get_bits () { return bits; };
+
+      //! size of the bitmap in bytes, a whole number of 64-bit words
+      size_t get_nbytes () { return nwords * sizeof(uint64_t); };
+
+    private:
+
+      //! zero a run of bytes without reading it into the cache
+      static void fill_zero (char * ptr, size_t nbytes);
+
+      uint64_t block_size;
+
+      unsigned packet_size;
+
+      uint64_t npackets;
+
+      uint64_t nwords;
+
+      uint64_t * bits;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef __ReceiveEngine_h
+#define __ReceiveEngine_h
+
+#include "spip/UDPPacketBatch.h"
+
+#include <cstring>
+#include <typeinfo>
+
+namespace spip {
+
+  //! Receive batch compiled for a concrete format and socket class. Calls
+  //! to the socket and format are statically bound, and payloads of formats
+  //! with a fixed UDPFormatLayout are copied with compile-time sizes.
+  //! Receivers construct it through create, binaries select it with
+  //! set_engine<Format, Socket> on the receiver
+  template <class Format, class Socket>
+  class ReceiveEngine : public UDPPacketBatch {
+
+    public:
+
+      ReceiveEngine (Format * _fmt, Socket * _sock)
+        : UDPPacketBatch (_fmt, _sock), fmt (_fmt), socket (_sock) {};
+
+      ~ReceiveEngine () {};
+
+      //! engine for the format and socket if they are exactly Format and
+      //! Socket, otherwise a batch that dispatches at run time
+      static UDPPacketBatch * create (UDPFormat * fmt, UDPSocketReceive * sock)
+      {
+        if (typeid(*fmt) != typeid(Format) || (sock && typeid(*sock) != typeid(Socket)))
+          return new UDPPacketBatch (fmt, sock);
+        return new ReceiveEngine<Format, Socket> (static_cast<Format *>(fmt),
+                                                  static_cast<Socket *>(sock));
+      };
+
+      int receive ()
+      {
+        int n = socket->Socket::recv_batch ();
+        if (n > 0)
+          ReceiveEngine::decode (socket->get_packets(), n);
+        return n;
+      };
+
+      void decode (char ** _packets, unsigned _npackets)
+      {
+        reset (_packets, _npackets);
+        if (npackets > 0)
+          fmt->Format::decode_batch (packets, npackets, &offsets[0], &payload_sizes[0]);
+      };
+
+      void flush (unsigned iend)
+      {
+        if (iend <= nflushed)
+          return;
+
+        if (scatter_block)
+          UDPPacketBatch::flush (iend);
+        else if (UDPFormatLayout<Format>::data_size > 0)
+        {
+          for (unsigned i=nflushed; i<iend; i++)
+            if (dests[i])
+              memcpy (dests[i], packets[i] + UDPFormatLayout<Format>::header_size,
+                      UDPFormatLayout<Format>::data_size);
+        }
+        else
+          fmt->Format::insert_batch (packets + nflushed, iend - nflushed,
+                                     &dests[nflushed], &payload_sizes[nflushed]);
+        nflushed = iend;
+      };
+
+    private:
+
+      Format * fmt;
+
+      Socket * socket;
+
+  };
+
+}
+
+#endif
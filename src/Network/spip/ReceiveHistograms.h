@@ -0,0 +1,94 @@
+
+#ifndef __ReceiveHistograms_h
+#define __ReceiveHistograms_h
+
+#include "spip/LatencyHistogram.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace spip {
+
+  //! Latency histograms of one capture thread of a receiver, recorded
+  //! when RECV_HISTOGRAMS is set in the configuration. Each histogram has
+  //! a single writer: the capture thread records the arrival, processing
+  //! and block wait times, the thread that owns the data block records
+  //! the open and close times.
+  //!
+  //! With batched receives the interval between receive calls that
+  //! returned packets is recorded as the inter-arrival time, and the
+  //! processing time of a batch is recorded per packet, so both are per
+  //! packet when UDP_RECV_BATCH is 1
+  class ReceiveHistograms {
+
+    public:
+
+      ReceiveHistograms ();
+
+      ~ReceiveHistograms ();
+
+      //! a receive call returned npackets
+      void received (unsigned npackets)
+      {
+        const uint64_t now = LatencyHistogram::get_ticks();
+        if (prev_arrival)
+          inter_arrival.record (now - prev_arrival);
+        prev_arrival = batch_start = now;
+        batch_npackets = npackets;
+      }
+
+      //! the packets of the last receive call have been placed
+      void processed ()
+      {
+        if (batch_npackets)
+        {
+          processing.record ((LatencyHistogram::get_ticks() - batch_start) / batch_npackets);
+          batch_npackets = 0;
+        }
+      }
+
+      //! time since start waiting for a buffer to be published
+      void waited (uint64_t start) { block_wait.record_since (start); };
+
+      //! time since start in opening a data block buffer
+      void opened (uint64_t start) { open_block.record_since (start); };
+
+      //! time since start in closing a data block buffer
+      void closed (uint64_t start) { close_block.record_since (start); };
+
+      //! clear the histograms before an observation
+      void reset ();
+
+      //! print the non-empty histograms, each line prefixed by name
+      void print (std::ostream& os, const std::string& name, bool buckets);
+
+      //! print the histograms of each capture thread
+      static void print (std::ostream& os, const std::vector<ReceiveHistograms *>& histograms, bool buckets);
+
+      //! reply to a query on a control connection
+      static void send (int fd, const std::vector<ReceiveHistograms *>& histograms);
+
+    private:
+
+      LatencyHistogram inter_arrival;
+
+      LatencyHistogram processing;
+
+      LatencyHistogram block_wait;
+
+      LatencyHistogram open_block;
+
+      LatencyHistogram close_block;
+
+      uint64_t prev_arrival;
+
+      uint64_t batch_start;
+
+      unsigned batch_npackets;
+
+  };
+
+}
+
+#endif
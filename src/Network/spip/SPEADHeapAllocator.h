@@ -0,0 +1,100 @@
+#ifndef __SPEADHeapAllocator_h
+#define __SPEADHeapAllocator_h
+
+#include "spead2/common_memory_allocator.h"
+#include "spead2/common_memory_pool.h"
+
+#include <map>
+#include <memory>
+#include <pthread.h>
+#include <inttypes.h>
+
+namespace spip {
+
+  //! spead2 allocator that assembles CBF raw beam former heaps directly in
+  //! the data block. The destination is computed from the timestamp item of
+  //! the first packet of each heap, heaps that do not belong in the current
+  //! or next data block buffer are allocated from the fallback pool
+  class SPEADHeapAllocator : public spead2::memory_allocator {
+
+    public:
+
+      SPEADHeapAllocator (std::shared_ptr<spead2::memory_pool> pool,
+                          unsigned bytes_per_heap, unsigned samples_per_heap,
+                          double adc_to_bf_sampling_ratio);
+
+      ~SPEADHeapAllocator ();
+
+      //! ADC sample that corresponds to heap 0 of the observation
+      void set_start_adc_sample (int64_t start_adc_sample);
+
+      //! buffers that may be written, heaps [first_heap, first_heap + heaps_per_buf)
+      //! are placed in curr and the following heaps_per_buf heaps in next,
+      //! which may be NULL if the lookahead buffer is not yet available
+      void set_window (char * curr, char * next, uint64_t first_heap, uint64_t heaps_per_buf);
+
+      //! stop placing heaps in the data block
+      void clear_window ();
+
+      //! stop placing heaps in buf, heaps already placed in it may still
+      //! be written until they are released. Lasts until the window moves
+      //! to another current buffer or is cleared
+      void retire (char * buf);
+
+      //! number of heaps placed in buf that have not been released, the
+      //! buffer may only be closed once there are none
+      uint64_t get_nlive (char * buf);
+
+      //! heap number of the timestamp, or -1 if it precedes the start
+      int64_t get_heap (uint64_t timestamp);
+
+      //! number of heaps allocated in the data block and from the pool
+      uint64_t get_nplaced () { return nplaced; };
+
+      uint64_t get_npooled () { return npooled; };
+
+      virtual pointer allocate (std::size_t size, void * hint) override;
+
+    private:
+
+      //! heaps placed in the data block are released with the buffer
+      virtual void free (std::uint8_t * ptr, void * user) override;
+
+      //! timestamp immediate from the packet header, 0 if not present
+      static uint64_t get_timestamp (const void * hint);
+
+      std::shared_ptr<spead2::memory_pool> pool;
+
+      pthread_mutex_t mutex;
+
+      unsigned bytes_per_heap;
+
+      unsigned samples_per_heap;
+
+      double adc_to_bf_sampling_ratio;
+
+      int64_t start_adc_sample;
+
+      char * curr;
+
+      char * next;
+
+      //! buffer in which no further heaps are placed
+      char * retired;
+
+      //! heaps that have not been released, by the buffer they were placed in
+      std::map<char *, uint64_t> live;
+
+      uint64_t first_heap;
+
+      uint64_t heaps_per_buf;
+
+      uint64_t nplaced;
+
+      uint64_t npooled;
+
+  };
+
+}
+
+#endif
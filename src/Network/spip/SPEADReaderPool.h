@@ -0,0 +1,102 @@
+#ifndef __SPEADReaderPool_h
+#define __SPEADReaderPool_h
+
+#include <boost/asio.hpp>
+
+#include "spead2/common_thread_pool.h"
+#include "spead2/recv_stream.h"
+
+#include "spip/UDPStats.h"
+
+#include <string>
+#include <vector>
+#include <inttypes.h>
+
+namespace spip {
+
+  //! spead2 worker threads and the UDP readers that feed a stream. The
+  //! configuration is read from the header:
+  //!   SPEAD_NWORKERS      number of spead2 worker threads [1]
+  //!   SPEAD_WORKER_CORES  comma separated cores the workers are bound to
+  //!   SPEAD_NREADERS      readers per endpoint, sharing the port via SO_REUSEPORT [1]
+  //!   SPEAD_READER_BUFFER socket receive buffer of each reader in bytes [128 MiB]
+  //!   SPEAD_PACKET_SIZE   nominal packet size for the loss statistics [9200]
+  //!   SPEAD_PORTS         comma separated ports, one endpoint per port
+  //!   SPEAD_MCAST         comma separated multicast groups, one per port or
+  //!                       a single group shared by all ports
+  class SPEADReaderPool {
+
+    public:
+
+      SPEADReaderPool ();
+
+      ~SPEADReaderPool ();
+
+      void configure (const char * config);
+
+      //! receive from a single endpoint in place of SPEAD_PORTS and SPEAD_MCAST,
+      //! the group may be empty for unicast
+      void set_endpoint (int port, std::string group);
+
+      //! start the worker threads, the port is used if SPEAD_PORTS was not
+      //! configured and the address is the interface for multicast groups
+      void prepare (std::string ip_address, int port);
+
+      spead2::thread_pool& get_worker () { return *worker; };
+
+      //! add the readers for every endpoint to the stream
+      void add_readers (spead2::recv::stream& stream);
+
+      //! refresh the loss statistics from the kernel's socket drop counters
+      void update_stats ();
+
+      void print_stats ();
+
+      unsigned get_nreaders () { return reader_inodes.size(); };
+
+      unsigned get_nendpoints () { return ports.size(); };
+
+      UDPStats * get_stats (unsigned ireader) { return stats[ireader]; };
+
+    private:
+
+      void bind_workers ();
+
+      //! bind the calling worker thread to its core, run once on each worker
+      void bind_worker ();
+
+      std::vector<int> ports;
+
+      std::vector<std::string> groups;
+
+      std::string interface;
+
+      unsigned nworkers;
+
+      std::vector<int> worker_cores;
+
+      unsigned nbound;
+
+      pthread_barrier_t barrier;
+
+      unsigned nreaders;
+
+      size_t buffer_size;
+
+      unsigned packet_size;
+
+      spead2::thread_pool * worker;
+
+      //! inode of each reader's socket, which identifies it in /proc/net/udp
+      std::vector<uint64_t> reader_inodes;
+
+      //! kernel drop counter of each reader when last read
+      std::vector<uint64_t> reader_drops;
+
+      std::vector<UDPStats *> stats;
+
+  };
+
+}
+
+#endif
@@ -12,6 +12,8 @@
 
 #include "spip/DataBlockWrite.h"
 #include "spip/SPEADBeamFormerConfig.h"
+#include "spip/SPEADReaderPool.h"
+#include "spip/ReceiveHistograms.h"
 
 #include <iostream>
 #include <cstdlib>
@@ -57,6 +59,10 @@ namespace spip {
 
       uint64_t get_data_bufsz () { return db->get_data_bufsz(); };
 
+      unsigned get_nreaders () { return readers.get_nreaders(); };
+
+      UDPStats * get_reader_stats (unsigned i) { return readers.get_stats (i); };
+
     protected:
 
       void control_thread ();
@@ -115,6 +121,11 @@ namespace spip {
 
       SPEADBeamFormerConfig bf_config;
 
+      SPEADReaderPool readers;
+
+      //! heap latency histograms, if RECV_HISTOGRAMS is set
+      std::vector<ReceiveHistograms *> histograms;
+
       uint64_t timestamp;
   };
 
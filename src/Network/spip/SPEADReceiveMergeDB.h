@@ -1,4 +1,3 @@
-
 #ifndef __SPEADReceiveMergeDB_h
 #define __SPEADReceiveMergeDB_h
 
@@ -12,9 +11,12 @@
 
 #include "spip/DataBlockWrite.h"
 #include "spip/SPEADBeamFormerConfig.h"
+#include "spip/SPEADReaderPool.h"
+#include "spip/UDPStats.h"
 
 #include <iostream>
 #include <cstdlib>
+#include <vector>
 #include <pthread.h>
 
 namespace spip {
@@ -22,6 +24,10 @@ namespace spip {
   enum ControlCmd   { None, Start, Stop, Quit };
   enum ControlState { Idle, Active, Stopping };
 
+  //! Merges N SPEAD substreams, each carrying a contiguous subset of the
+  //! channels, into one data block. Substream i is configured by the keys
+  //! START_CHANNEL_i, END_CHANNEL_i, DATA_PORT_i and DATA_MCAST_i, and its
+  //! heaps are written at the offset of its channels within each merged heap
   class SPEADReceiveMergeDB {
 
     public:
@@ -32,7 +38,10 @@ namespace spip {
 
       int configure (const char * config);
 
-      void prepare (std::string ip_address1, int port1, std::string ip_address2, int port2);
+      //! the address is the interface on which multicast groups are joined
+      void prepare (std::string ip_address);
+
+      unsigned get_nsubstream () { return nsubstream; };
 
       void start_control_thread (int port);
 
@@ -43,7 +52,7 @@ namespace spip {
 
       void stop_control_thread ();
 
-      void start_threads (int core1, int core2);
+      void start_threads (const std::vector<int>& cores);
 
       void join_threads ();
 
@@ -54,17 +63,14 @@ namespace spip {
 
       bool datablock_thread ();
 
-      static void * recv_thread1_wrapper (void * obj)
-      {
-        ((SPEADReceiveMergeDB*) obj )->receive_thread (0);
-      }
-
-      static void * recv_thread2_wrapper (void * obj)
+      static void * recv_thread_wrapper (void * arg)
       {
-        ((SPEADReceiveMergeDB*) obj )->receive_thread (1);
+        recv_thread_arg_t * recv_arg = (recv_thread_arg_t *) arg;
+        recv_arg->obj->receive_thread (recv_arg->isubstream);
+        pthread_exit (NULL);
       }
 
-      bool receive_thread (int pol);
+      bool receive_thread (unsigned isubstream);
 
       void open ();
 
@@ -72,14 +78,16 @@ namespace spip {
 
       void close ();
 
-      bool receive ();
+      void start_capture () { set_control_cmd (Start); };
 
-      void start_capture () { control_cmd = Start; };
+      void stop_capture () { set_control_cmd (Quit); };
 
-      void stop_capture () { control_cmd = Quit; };
+      void set_control_cmd (ControlCmd cmd);
 
       uint64_t get_data_bufsz () { return db->get_data_bufsz(); };
 
+      UDPStats * get_stats (unsigned isubstream) { return stats[isubstream]; };
+
     protected:
 
       void control_thread ();
@@ -119,38 +127,76 @@ namespace spip {
       char verbose;
 
     private:
-  
-      char * block;
-          
+
+      typedef struct {
+        SPEADReceiveMergeDB * obj;
+        unsigned isubstream;
+      } recv_thread_arg_t;
+
+      //! publish any cleared buffers in the ring to the receive threads
+      void publish_blocks ();
+
+      //! return block iblock, waiting only if the ring of blocks is full
+      char * wait_for_block (uint64_t iblock, UDPStats * stat);
+
+      //! mark block ibuf complete for the substream and advance ibuf
+      void complete_block (unsigned isubstream, uint64_t& ibuf, std::vector<uint64_t>& heaps_in);
+
       pthread_t control_thread_id;
 
       pthread_t datablock_thread_id;
 
-      pthread_t recv_thread1_id;
+      std::vector<pthread_t> recv_thread_ids;
 
-      pthread_t recv_thread2_id;
+      std::vector<recv_thread_arg_t> recv_thread_args;
 
+      //! signals changes of the control command and state
       pthread_cond_t cond;
 
       pthread_mutex_t mutex;
 
-      uint64_t curr_heap;
+      unsigned nsubstream;
+
+      //! first channel of the merged band
+      unsigned start_channel;
+
+      //! bytes of one channel in a merged heap
+      uint64_t bytes_per_chan;
+
+      //! offset and size of each substream's channels in a merged heap
+      std::vector<uint64_t> substream_offsets;
+
+      std::vector<uint64_t> substream_sizes;
+
+      std::vector<int> spead_ports;
+
+      std::vector<std::string> spead_mcasts;
+
+      std::vector<int> cores;
 
-      uint64_t next_heap;
+      std::vector<SPEADReaderPool *> readers;
 
-      std::string spead_ips[2];
+      std::vector<UDPStats *> stats;
 
-      int spead_ports[2];
+      //! number of data block buffers available to the receive threads
+      unsigned ring_depth;
 
-      int cores[2];
+      //! buffer of each published block, indexed by block % ring_depth
+      std::vector<char *> ring_blocks;
 
-      bool full[2];
+      //! number of blocks published, written only by the datablock thread
+      uint64_t nblocks_published;
 
-      unsigned heap_size;
+      //! number of blocks closed, written only by the datablock thread
+      uint64_t nblocks_closed;
 
-      SPEADBeamFormerConfig bf_config;
+      //! blocks completed by a receive thread, padded to a cache line
+      typedef struct {
+        uint64_t nblocks;
+        char pad[56];
+      } substream_counter_t;
 
-      uint64_t timestamp;
+      std::vector<substream_counter_t> substream_counters;
   };
 
 }
@@ -10,6 +10,7 @@
 #include "spead2/recv_ring_stream.h"
 
 #include "spip/SPEADBeamFormerConfig.h"
+#include "spip/SPEADReaderPool.h"
 
 #include <iostream>
 #include <cstdlib>
@@ -42,6 +43,10 @@ namespace spip {
 
       void close();
 
+      unsigned get_nreaders () { return readers.get_nreaders(); };
+
+      UDPStats * get_reader_stats (unsigned i) { return readers.get_stats (i); };
+
     protected:
 
       bool keep_receiving;
@@ -76,7 +81,7 @@ namespace spip {
 
       //boost::asio::ip::udp::endpoint endpoint;
 
-      spead2::thread_pool worker;
+      SPEADReaderPool readers;
 
       std::shared_ptr<spead2::memory_pool> pool;
 
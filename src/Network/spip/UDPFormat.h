@@ -16,13 +16,21 @@
 
 namespace spip {
 
+  //! packet layout of a format that is fixed at compile time, zero if it is
+  //! only known at run time. Specialised by formats with a fixed layout
+  template <class Format>
+  struct UDPFormatLayout {
+    static const unsigned header_size = 0;
+    static const unsigned data_size = 0;
+  };
+
   class UDPFormat {
 
     public:
 
       UDPFormat();
 
-      ~UDPFormat();
+      virtual ~UDPFormat();
 
       virtual void configure (const AsciiHeader& config, const char* suffix) = 0;
 
@@ -42,6 +50,11 @@ namespace spip {
 
       virtual void gen_packet (char * buf, size_t bufsz) = 0;
 
+      //! write the next packet of the sequence to buf, which already holds a
+      //! complete packet of this format, storing only the header fields
+      //! that differ between packets. By default the packet is generated
+      virtual void patch_packet (char * buf) { gen_packet (buf, packet_header_size + packet_data_size); };
+
       virtual uint64_t get_samples_for_bytes (uint64_t nbytes) = 0;
 
       virtual void encode_header_seq (char * buf, uint64_t packet_number) = 0;
@@ -52,6 +65,17 @@ namespace spip {
 
       virtual int insert_last_packet (char * buf) = 0;
 
+      //! decode npackets packets, as decode_packet on each in turn, storing
+      //! the byte offset (-ve if not to be written) and payload size of each
+      virtual void decode_batch (char ** packets, unsigned npackets,
+                                 int64_t * offsets, unsigned * payload_sizes);
+
+      //! write the payload_sizes[i] bytes of payload of each packet of a
+      //! decoded batch to dests[i], packets with a NULL destination are
+      //! skipped. Packets are not decoded again
+      virtual void insert_batch (char ** packets, unsigned npackets,
+                                 char ** dests, const unsigned * payload_sizes);
+
       virtual void print_packet_header () = 0;
 
       virtual uint64_t get_resolution () = 0;
@@ -64,8 +88,15 @@ namespace spip {
 
       double rand_normal (double mean, double stddev);
 
+      //! fill the noise buffer with normally distributed nbits values of
+      //! the default rms for nbits, generated in parallel
       void generate_noise_buffer (int nbits);
 
+      //! fill the noise buffer with normally distributed nbits values of
+      //! the rms, 0 for the default of nbits
+      void generate_noise_buffer (int nbits, double rms);
+
+      //! copy nbytes from a random offset in the noise buffer to buf
       void fill_noise (char * buf, size_t nbytes);
 
       void set_noise_buffer_size (unsigned nbytes);
@@ -76,6 +107,10 @@ namespace spip {
       //! get whether this format is self starting
       bool get_self_start () { return self_start; };
 
+      //! get whether the payload of every packet is written contiguously
+      //! at a multiple of the data size in the data stream
+      bool get_packet_aligned () { return packet_aligned; };
+
       //! return the UTC second start time for this format
       Time get_utc_start () { return utc_start; };
 
@@ -120,12 +155,17 @@ namespace spip {
 
       size_t noise_buffer_size;
 
+      //! state of the generator choosing offsets in the noise buffer
+      unsigned noise_seed;
+
       bool configured;
 
       bool prepared;
 
       bool self_start;
 
+      bool packet_aligned;
+
     private:
 
   };
@@ -8,9 +8,31 @@
 #include "spip/UDPStats.h"
 
 #include <cstdlib>
+#include <vector>
+#include <pthread.h>
+
+// messages passed to each sendmmsg call by the batched senders
+#define UDP_GENERATOR_NMSG 32
+
+// limits of a single UDP GSO send
+#define UDP_GENERATOR_GSO_MAX_BYTES 65507
+#define UDP_GENERATOR_GSO_MAX_SEGMENTS 64
+
+// bytes of pre-rendered packets each batched sender cycles through
+#define UDP_GENERATOR_RING_BYTES 8388608
+
+// bytes of noise from which the packet payloads are rendered
+#define UDP_GENERATOR_NOISE_BYTES 16777216
 
 namespace spip {
 
+  //! Generates UDP packets of a format. transmit sends one packet per call
+  //! from the calling thread, transmit_batched sends from one thread per
+  //! format, each generating a contiguous subset of the channels from a
+  //! ring of pre-rendered packets. The batched senders are configured from
+  //! the header:
+  //!   UDPGEN_CORES  comma separated cores the sender threads are bound to
+  //!   UDPGEN_GSO    use UDP generic segmentation offload if available [1]
   class UDPGenerator {
 
     public:
@@ -25,13 +47,35 @@ namespace spip {
 
       void set_format (UDPFormat * format);
 
+      //! add the format of a further sender thread for transmit_batched,
+      //! must be called after set_format and before configure
+      void add_format (UDPFormat * format);
+
+      unsigned get_nformats () { return formats.size(); };
+
+      UDPFormat * get_format (unsigned iformat) { return formats[iformat]; };
+
       void prepare ();
 
       // transmission thread
       void transmit (unsigned tobs, float data_rate);
 
+      //! transmit for tobs seconds at data_rate [b/s] with one thread per
+      //! format, a data_rate of 0 transmits at the configured data rate
+      void transmit_batched (unsigned tobs, double data_rate);
+
+      static void * sender_thread_wrapper (void * arg)
+      {
+        sender_thread_arg_t * sender_arg = (sender_thread_arg_t *) arg;
+        sender_arg->obj->sender_thread (sender_arg->ithread);
+        pthread_exit (NULL);
+      }
+
       UDPStats * get_stats () { return stats; };
 
+      //! bytes transmitted by transmit or all the sender threads
+      uint64_t get_data_transmitted ();
+
       void stop_transmit () { keep_transmitting = false; };
 
     protected:
@@ -66,11 +110,44 @@ namespace spip {
 
       size_t signal_buffer_size;
 
-      unsigned bits_per_second;
+      uint64_t bits_per_second;
 
-      unsigned bytes_per_second;
+      uint64_t bytes_per_second;
 
       bool keep_transmitting;
+
+    private:
+
+      typedef struct {
+        UDPGenerator * obj;
+        unsigned ithread;
+      } sender_thread_arg_t;
+
+      //! generate and send the packets of one format, paced by a token bucket
+      void sender_thread (unsigned ithread);
+
+      //! formats of the sender threads, the first is format
+      std::vector<UDPFormat *> formats;
+
+      //! header of each sender thread, with its channel range
+      std::vector<AsciiHeader *> thread_headers;
+
+      std::vector<UDPStats *> thread_stats;
+
+      //! fraction of the band generated by each sender thread
+      std::vector<double> thread_fractions;
+
+      //! data bytes per second of each sender thread
+      std::vector<double> thread_rates;
+
+      //! data bytes each sender thread is to transmit
+      std::vector<uint64_t> thread_bytes;
+
+      std::vector<int> cores;
+
+      bool use_gso;
+
+      pthread_barrier_t barrier;
   };
 
 }
@@ -0,0 +1,89 @@
+#ifndef __UDPPacketBatch_h
+#define __UDPPacketBatch_h
+
+#include "spip/UDPFormat.h"
+#include "spip/UDPSocketReceive.h"
+
+#include <vector>
+
+namespace spip {
+
+  //! Packets of one receive batch, decoded together by a format. Receive
+  //! loops place each packet at a destination, then write the payloads of
+  //! placed packets with a single insert_batch call
+  class UDPPacketBatch {
+
+    public:
+
+      UDPPacketBatch (UDPFormat * fmt, UDPSocketReceive * sock);
+
+      virtual ~UDPPacketBatch ();
+
+      //! batch that dispatches to any format and socket at run time
+      static UDPPacketBatch * create (UDPFormat * fmt, UDPSocketReceive * sock);
+
+      //! receive and decode the next batch from the socket, returning the
+      //! number of packets or -1 if none were available
+      virtual int receive ();
+
+      //! decode the packets, clearing their destinations
+      virtual void decode (char ** packets, unsigned npackets);
+
+      int64_t get_offset (unsigned i) { return offsets[i]; };
+
+      unsigned get_payload_size (unsigned i) { return payload_sizes[i]; };
+
+      //! set the destination of the payload of packet i
+      void place (unsigned i, char * dest) { dests[i] = dest; };
+
+      //! destination of packet i, NULL if it was not placed
+      char * get_dest (unsigned i) { return dests[i]; };
+
+      //! write the payloads of the placed packets before packet iend
+      virtual void flush (unsigned iend);
+
+      //! write the payloads of all placed packets
+      void flush () { flush (npackets); };
+
+      //! write each run of block bytes of a payload stride bytes after the
+      //! previous run, rather than contiguously. 0 disables the scatter
+      void set_scatter (unsigned block, unsigned stride);
+
+    protected:
+
+      //! size the per-packet arrays and clear the destinations
+      void reset (char ** packets, unsigned npackets);
+
+      UDPFormat * format;
+
+      UDPSocketReceive * sock;
+
+      char ** packets;
+
+      unsigned npackets;
+
+      //! packets before this one have been written
+      unsigned nflushed;
+
+      std::vector<int64_t> offsets;
+
+      std::vector<unsigned> payload_sizes;
+
+      std::vector<char *> dests;
+
+      //! bytes of each run and spacing of the runs of a scattered payload
+      unsigned scatter_block;
+
+      unsigned scatter_stride;
+
+      //! payload inserted before it is scattered
+      std::vector<char> scatter_buf;
+
+  };
+
+  //! constructs the batch used by a receive loop for a format and socket
+  typedef UDPPacketBatch * (*UDPPacketBatchFactory) (UDPFormat *, UDPSocketReceive *);
+
+}
+
+#endif
@@ -8,10 +8,15 @@
 #include "spip/UDPSocketReceive.h"
 #include "spip/UDPFormat.h"
 #include "spip/UDPStats.h"
+#include "spip/UDPStatsSegment.h"
+#include "spip/PacketBitmap.h"
+#include "spip/ReceiveHistograms.h"
+#include "spip/ReceiveEngine.h"
 #include "spip/DataBlockWrite.h"
 
 #include <iostream>
 #include <cstdlib>
+#include <vector>
 #include <pthread.h>
 
 #ifdef  HAVE_VMA
@@ -37,6 +42,15 @@ namespace spip {
 
       void set_format (UDPFormat * fmt);
 
+      //! add a format for an additional capture thread. Each capture
+      //! thread has its own SO_REUSEPORT socket on the data port
+      void add_format (UDPFormat * fmt);
+
+      //! receive with the engine compiled for Format and Socket, used when
+      //! the format and socket are exactly these classes
+      template <class Format, class Socket>
+      void set_engine () { batch_factory = &ReceiveEngine<Format, Socket>::create; };
+
       void start_control_thread (int port);
 
       void stop_control_thread ();
@@ -66,6 +80,15 @@ namespace spip {
 
       UDPStats * get_stats () { return stats; };
 
+      static void * capture_thread_wrapper (void * arg)
+      {
+        capture_thread_arg_t * capture_arg = (capture_thread_arg_t *) arg;
+        capture_arg->obj->capture_thread (capture_arg->ithread);
+        pthread_exit (NULL);
+      }
+
+      void capture_thread (unsigned ithread);
+
       uint64_t get_data_bufsz () { return db->get_data_bufsz(); };
 
     protected:
@@ -76,22 +99,95 @@ namespace spip {
 
       void update_stats();
 
+      //! open the receive socket for capture thread i
+      UDPSocketReceive * open_socket (unsigned i);
+
+      //! receive with multiple capture threads into the shared block
+      bool receive_parallel ();
+
+      //! publish any cleared buffers in the window to the capture threads
+      void publish_blocks ();
+
+      //! return block iblock, waiting only if the window is not yet published
+      char * wait_for_block (uint64_t iblock, UDPStats * stat, ReceiveHistograms * hist);
+
+      //! move the window of every capture thread to start at iblock or later
+      void raise_frontier (uint64_t iblock);
+
+      //! advance the block of a capture thread past completed blocks
+      void advance_capture (unsigned ithread, uint64_t * ibuf);
+
+      //! write and account the placed packets [ifirst, iend) of a batch
+      void commit_capture (UDPPacketBatch * batch, unsigned ifirst, unsigned iend, UDPStats * stat);
+
+      //! allocate or clear the packet bitmaps of the reorder window
+      void prepare_bitmaps ();
+
+      //! zero-fill and publish the packet bitmap of a block before closing it
+      void conclude_block (char * block, unsigned islot);
+
       std::string data_host;
 
       std::string data_mcast;
 
       int data_port;
 
+      //! number of packets to receive per system call
+      unsigned recv_batch;
+
+      //! kernel receive path: socket (default), ring or xdp
+      std::string recv_socket;
+
+      //! NIC receive queue for the xdp receive path
+      unsigned xdp_queue;
+
+      //! number of data block buffers in the packet reorder window
+      unsigned reorder_depth;
+
+      //! payload offset of a 32-bit field used to steer packets to capture
+      //! threads, -1 for the kernel's SO_REUSEPORT flow hash
+      int steer_offset;
+
+      //! cpu cores of the capture threads, from UDP_CAPTURE_CORES
+      std::vector<int> capture_cores;
+
+      //! formats, sockets and stats of each capture thread, [0] is the main
+      std::vector<UDPFormat *> formats;
+
+      std::vector<UDPSocketReceive *> socks;
+
+      std::vector<UDPStats *> capture_stats;
+
+      //! latency histograms of each capture thread, if RECV_HISTOGRAMS is set
+      std::vector<ReceiveHistograms *> histograms;
+
+      bool record_histograms;
+
       UDPSocketReceive * sock;
 
       UDPFormat * format;
 
+      //! constructs the packet batch of each receive loop
+      UDPPacketBatchFactory batch_factory;
+
       UDPStats * stats;
 
       pthread_t stats_thread_id;
 
+      //! shared memory segment to which the stats thread publishes
+      std::string stats_segment_name;
+
       DataBlockWrite * db;
 
+      //! optional sidecar data block of packet bitmaps, one per data block
+      DataBlockWrite * bitmap_db;
+
+      //! zero the payload of missing packets before closing each block
+      bool zero_fill;
+
+      //! packet bitmap of each block in the reorder window
+      std::vector<PacketBitmap *> bitmaps;
+
       pthread_t control_thread_id;
 
       int control_port;
@@ -143,6 +239,40 @@ namespace spip {
 
       struct timeval curr;
       struct timeval prev;
+
+    private:
+
+      typedef struct {
+        UDPReceiveDB * obj;
+        unsigned ithread;
+      } capture_thread_arg_t;
+
+      std::vector<pthread_t> capture_thread_ids;
+
+      std::vector<capture_thread_arg_t> capture_thread_args;
+
+      //! buffer of each published block, indexed by block % reorder_depth
+      std::vector<char *> window_blocks;
+
+      //! bytes written to each published block by all capture threads
+      std::vector<uint64_t> window_bytes;
+
+      //! number of blocks published, written only by the receive thread
+      uint64_t nblocks_published;
+
+      //! number of blocks closed, written only by the receive thread
+      uint64_t nblocks_closed;
+
+      //! first block that any capture thread may still write to
+      uint64_t nblocks_frontier;
+
+      //! blocks passed by a capture thread, padded to a cache line
+      typedef struct {
+        uint64_t nblocks;
+        char pad[56];
+      } capture_counter_t;
+
+      std::vector<capture_counter_t> capture_counters;
   };
 
 }
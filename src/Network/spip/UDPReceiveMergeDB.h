@@ -10,10 +10,14 @@
 #include "spip/UDPSocketReceive.h"
 #include "spip/UDPFormat.h"
 #include "spip/UDPStats.h"
+#include "spip/UDPStatsSegment.h"
+#include "spip/ReceiveHistograms.h"
+#include "spip/ReceiveEngine.h"
 #include "spip/DataBlockWrite.h"
 
 #include <iostream>
 #include <cstdlib>
+#include <vector>
 #include <pthread.h>
 
 #ifdef  HAVE_VMA
@@ -35,7 +39,15 @@ namespace spip {
 
       int configure (const char * config);
 
-      void set_formats (UDPFormat * fmt1, UDPFormat * fmt2);
+      //! append a stream, configured from the keys with suffix _<istream>
+      void add_format (UDPFormat * fmt);
+
+      unsigned get_nstream () { return formats.size(); };
+
+      //! receive with the engine compiled for Format and Socket, used when
+      //! the format and socket are exactly these classes
+      template <class Format, class Socket>
+      void set_engine () { batch_factory = &ReceiveEngine<Format, Socket>::create; };
 
       void set_control_cmd (ControlCmd cmd);
 
@@ -53,7 +65,8 @@ namespace spip {
         ((UDPReceiveMergeDB*) obj )->control_thread ();
       }
 
-      void start_threads (int core1, int core2);
+      //! start the threads, binding each receive thread to cores[istream]
+      void start_threads (const std::vector<int>& cores);
 
       void join_threads ();
 
@@ -65,19 +78,14 @@ namespace spip {
 
       bool datablock_thread ();
 
-      static void * recv_thread1_wrapper (void * obj)
-      {
-        ((UDPReceiveMergeDB*) obj )->receive_thread (0);
-        pthread_exit (NULL);
-      }
-
-      static void * recv_thread2_wrapper (void * obj)
+      static void * recv_thread_wrapper (void * arg)
       {
-        ((UDPReceiveMergeDB*) obj )->receive_thread (1);
+        recv_thread_arg_t * recv_arg = (recv_thread_arg_t *) arg;
+        recv_arg->obj->receive_thread (recv_arg->istream);
         pthread_exit (NULL);
       }
 
-      bool receive_thread (int pol);
+      bool receive_thread (unsigned istream);
 
       static void * stats_thread_wrapper (void * obj)
       {
@@ -109,13 +117,33 @@ namespace spip {
 
       ControlState control_state;
 
-      ControlState control_states[2];
+      //! number of streams merged into the data block
+      unsigned nstream;
+
+      //! merged layout: pol (streams are polarisations) or chan (sub-bands)
+      std::string merge_layout;
+
+      //! bytes of one time sample of a stream, each is written at its
+      //! stream's channel offset within the merged sample. 0 for pol
+      unsigned sample_size;
+
+      std::vector<std::string> data_hosts;
+
+      std::vector<int> data_ports;
+
+      std::vector<std::string> data_mcasts;
 
-      std::string data_hosts[2];
+      //! number of packets to receive per system call
+      unsigned recv_batch;
 
-      int data_ports[2];
+      //! kernel receive path: socket (default), ring or xdp
+      std::string recv_socket;
 
-      std::string data_mcasts[2];
+      //! NIC receive queue for the xdp receive path
+      unsigned xdp_queue;
+
+      //! number of data block buffers in the packet reorder window
+      unsigned reorder_depth;
 
       unsigned nchan;
 
@@ -142,38 +170,73 @@ namespace spip {
       char verbose;
 
     private:
-  
-      char * block;
-          
+
+      typedef struct {
+        UDPReceiveMergeDB * obj;
+        unsigned istream;
+      } recv_thread_arg_t;
+
       pthread_t control_thread_id;
 
       pthread_t datablock_thread_id;
 
-      pthread_t recv_thread1_id;
+      std::vector<pthread_t> recv_thread_ids;
 
-      pthread_t recv_thread2_id;
+      std::vector<recv_thread_arg_t> recv_thread_args;
 
       pthread_t stats_thread_id;
 
+      //! shared memory segment to which the stats thread publishes
+      std::string stats_segment_name;
+
       pthread_cond_t cond_db;
 
       pthread_mutex_t mutex_db;
 
-      pthread_cond_t cond_recvs[2];
+      //! receive threads wait on this for the start of an observation
+      pthread_cond_t cond_recv;
+
+      //! publish any cleared buffers in the ring to the receive threads
+      void publish_blocks ();
+
+      //! return block iblock, waiting only if the ring of blocks is full
+      char * wait_for_block (uint64_t iblock, UDPStats * stat, ReceiveHistograms * hist);
+
+      //! number of data block buffers available to the receive threads
+      unsigned ring_depth;
+
+      //! buffer of each published block, indexed by block % ring_depth
+      std::vector<char *> ring_blocks;
+
+      //! number of blocks published, written only by the datablock thread
+      uint64_t nblocks_published;
+
+      //! number of blocks closed, written only by the datablock thread
+      uint64_t nblocks_closed;
+
+      //! blocks completed by a receive thread, padded to a cache line
+      typedef struct {
+        uint64_t nblocks;
+        char pad[56];
+      } stream_counter_t;
 
-      pthread_mutex_t mutex_recvs[2];
+      std::vector<stream_counter_t> stream_counters;
 
-      UDPFormat * formats[2];
+      std::vector<UDPFormat *> formats;
 
-      UDPStats * stats[2];
+      //! constructs the packet batch of each receive loop
+      UDPPacketBatchFactory batch_factory;
 
-      int cores[2];
+      std::vector<UDPStats *> stats;
 
-      bool full[2];
+      //! latency histograms of each stream, if RECV_HISTOGRAMS is set. The
+      //! block open and close times are recorded in the first
+      std::vector<ReceiveHistograms *> histograms;
 
-      char * overflow;
+      std::vector<int> cores;
 
-      int64_t overflow_lastbytes[2];
+      //! offset of each stream's sub-chunk within a merged chunk
+      std::vector<uint64_t> stream_offsets;
 
       unsigned chunk_size;
 
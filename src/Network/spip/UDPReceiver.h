@@ -6,6 +6,7 @@
 #include "spip/UDPSocketReceive.h"
 #include "spip/UDPFormat.h"
 #include "spip/UDPStats.h"
+#include "spip/ReceiveEngine.h"
 
 #include <cstdlib>
 
@@ -29,6 +30,11 @@ namespace spip {
 
       void set_format (UDPFormat * fmt);
 
+      //! receive with the engine compiled for Format and Socket, used when
+      //! the format and socket are exactly these classes
+      template <class Format, class Socket>
+      void set_engine () { batch_factory = &ReceiveEngine<Format, Socket>::create; };
+
       void stop_receiving ();
 
       // transmission thread
@@ -44,6 +50,9 @@ namespace spip {
 
       UDPFormat * format;
 
+      //! constructs the packet batch of each receive loop
+      UDPPacketBatchFactory batch_factory;
+
       UDPStats * stats;
 
       std::string data_host;
@@ -52,6 +61,18 @@ namespace spip {
 
       int data_port;
 
+      //! number of packets to receive per system call
+      unsigned recv_batch;
+
+      //! kernel receive path: socket (default), ring or xdp
+      std::string recv_socket;
+
+      //! NIC receive queue for the xdp receive path
+      unsigned xdp_queue;
+
+      //! number of virtual blocks in the packet reorder window
+      unsigned reorder_depth;
+
       AsciiHeader header;
 
 #ifdef HAVE_VMA
@@ -5,6 +5,7 @@
 #include "spip/UDPSocket.h"
 
 #include <netinet/in.h>
+#include <sys/socket.h>
 
 namespace spip {
 
@@ -14,23 +15,72 @@ namespace spip {
 
       UDPSocketReceive ();
 
-      ~UDPSocketReceive ();
+      virtual ~UDPSocketReceive ();
 
       // open the socket
-      void open (std::string, int);
+      virtual void open (std::string, int);
 
       // open the socket and bind to a multicast group
-      void open_multicast (std::string, std::string, int port);
+      virtual void open_multicast (std::string, std::string, int port);
 
       // leave a multicast group on socket
       void leave_multicast ();
 
-      size_t resize_kernel_buffer (size_t);
+      //! share the port with other sockets, must precede open
+      void set_reuseport () { reuseport = true; };
+
+      //! steer datagrams across the SO_REUSEPORT group by a 32-bit
+      //! big-endian payload field at offset, modulo nsocks
+      void attach_reuseport_steering (unsigned offset, unsigned nsocks);
+
+      //! accept only datagrams whose 32-bit big-endian payload field at
+      //! offset, modulo nsocks, equals index. For multicast groups, where
+      //! every member socket receives a copy of each datagram
+      void attach_partition_filter (unsigned offset, unsigned nsocks, unsigned index)
+      {
+        attach_partition_filter (fd, offset, nsocks, index);
+      };
+
+      //! as attach_partition_filter, for any UDP socket descriptor
+      static void attach_partition_filter (int fd, unsigned offset, unsigned nsocks, unsigned index);
+
+      virtual size_t resize_kernel_buffer (size_t);
 
       size_t clear_buffered_packets ();
 
       size_t recv ();
 
+      //! allocate a ring of nmsgs packet slots, each of bufsz bytes
+      virtual void set_batch_size (unsigned nmsgs);
+
+      unsigned get_batch_size () { return batch_size; };
+
+      //! receive up to batch_size packets with a single system call
+      virtual int recv_batch ();
+
+      //! return pointer to the i'th packet of the last batch
+      char * get_packet (unsigned i) { return packets[i]; };
+
+      //! return pointers to the packets of the last batch
+      char ** get_packets () { return packets; };
+
+      //! return the size of the i'th packet of the last batch
+      unsigned get_packet_size (unsigned i) { return sizes[i]; };
+
+    protected:
+
+      //! return the index of the interface with the address, 0 for any
+      int get_interface_index (std::string);
+
+      //! number of packet slots in the batch ring
+      unsigned batch_size;
+
+      //! pointers to the payload of each packet in the last batch
+      char ** packets;
+
+      //! sizes of each packet in the last batch
+      unsigned * sizes;
+
     private:
 
       // size of the kernel socket buffer;
@@ -41,8 +91,17 @@ namespace spip {
 
       bool multicast;
 
+      bool reuseport;
+
       struct ip_mreq mreq;
 
+      //! contiguous storage for batch_size packets
+      char * ring;
+
+      struct iovec * iovs;
+
+      struct mmsghdr * msgs;
+
   };
 
 }
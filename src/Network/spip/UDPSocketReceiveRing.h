@@ -0,0 +1,78 @@
+#ifndef __UDPSocketReceiveRing_h
+#define __UDPSocketReceiveRing_h
+
+#include "spip/UDPSocketReceive.h"
+
+#include <linux/if_packet.h>
+
+namespace spip {
+
+  //! UDP receiver backed by a memory-mapped TPACKET_V3 PACKET_RX_RING.
+  //! Payload pointers remain valid until the next call to recv_batch. The
+  //! UDP socket is still opened to own the port and multicast membership
+  class UDPSocketReceiveRing : public UDPSocketReceive {
+
+    public:
+
+      UDPSocketReceiveRing ();
+
+      ~UDPSocketReceiveRing ();
+
+      // open the UDP socket and the packet socket on the matching interface
+      void open (std::string, int);
+
+      // open the sockets and bind to a multicast group
+      void open_multicast (std::string, std::string, int port);
+
+      //! map a PACKET_RX_RING of the specified size, returns the ring size
+      size_t resize_kernel_buffer (size_t);
+
+      //! ring blocks define the batch, only the packet slots are allocated
+      void set_batch_size (unsigned nmsgs);
+
+      //! release the previous ring block and walk the next retired block
+      int recv_batch ();
+
+    private:
+
+      void open_packet_socket (std::string, int);
+
+      void attach_port_filter (int);
+
+      void map_ring (size_t);
+
+      void unmap_ring ();
+
+      void release_block ();
+
+      void grow_packets (unsigned);
+
+      //! AF_PACKET socket file descriptor
+      int packet_fd;
+
+      //! interface index the packet socket is bound to, 0 for all
+      int ifindex;
+
+      //! mmap'd ring of block_nr blocks, each of block_size bytes
+      char * ring_base;
+
+      size_t ring_size;
+
+      unsigned block_size;
+
+      unsigned block_nr;
+
+      //! index of the next block to be read from the ring
+      unsigned block_idx;
+
+      //! block currently held by user space, released on next recv_batch
+      struct tpacket_block_desc * held_block;
+
+      //! number of packet slots allocated
+      unsigned packets_capacity;
+
+  };
+
+}
+
+#endif
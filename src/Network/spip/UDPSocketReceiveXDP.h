@@ -0,0 +1,106 @@
+#ifndef __UDPSocketReceiveXDP_h
+#define __UDPSocketReceiveXDP_h
+
+#include "spip/UDPSocketReceive.h"
+
+#include <linux/if_xdp.h>
+#include <inttypes.h>
+
+namespace spip {
+
+  //! UDP receiver backed by an AF_XDP socket on one NIC queue. An XDP
+  //! program redirects the data port into a UMEM shared with the receiver,
+  //! other traffic continues to the kernel. Native mode is attempted first,
+  //! falling back to generic (SKB) mode on drivers without XDP support
+  class UDPSocketReceiveXDP : public UDPSocketReceive {
+
+    public:
+
+      UDPSocketReceiveXDP (unsigned queue);
+
+      ~UDPSocketReceiveXDP ();
+
+      // open the UDP socket and the XDP socket on the matching interface
+      void open (std::string, int);
+
+      // open the sockets and bind to a multicast group
+      void open_multicast (std::string, std::string, int port);
+
+      //! allocate a UMEM of the specified size and attach the XDP program
+      size_t resize_kernel_buffer (size_t);
+
+      //! maximum number of packets taken from the RX ring per call
+      void set_batch_size (unsigned nmsgs);
+
+      //! return the previous batch to the fill ring, take the next batch
+      int recv_batch ();
+
+      //! true if the XDP program is attached in generic (SKB) mode
+      bool get_generic_mode () { return generic_mode; };
+
+    private:
+
+      //! producer/consumer ring shared with the kernel
+      typedef struct {
+        uint32_t * producer;
+        uint32_t * consumer;
+        void * desc;
+        uint32_t mask;
+        void * map;
+        size_t map_size;
+      } xdp_ring_t;
+
+      void open_xdp_socket (std::string, int);
+
+      void map_xdp_ring (xdp_ring_t *, struct xdp_ring_offset *, uint32_t, size_t, uint64_t);
+
+      void load_program ();
+
+      void attach_program ();
+
+      void release_frames ();
+
+      void close_xdp ();
+
+      //! NIC receive queue bound to the XDP socket
+      unsigned queue_id;
+
+      int ifindex;
+
+      int port;
+
+      int xsk_fd;
+
+      int map_fd;
+
+      int prog_fd;
+
+      int link_fd;
+
+      bool generic_mode;
+
+      //! UMEM packet buffer, nframes of frame_size bytes
+      char * umem;
+
+      size_t umem_size;
+
+      unsigned frame_size;
+
+      unsigned nframes;
+
+      xdp_ring_t rx;
+
+      xdp_ring_t fill;
+
+      xdp_ring_t comp;
+
+      //! UMEM addresses held by the last batch
+      uint64_t * held;
+
+      unsigned nheld;
+
+  };
+
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include "spip/UDPSocket.h"
 
 #include <netinet/in.h>
+#include <sys/socket.h>
 
 namespace spip {
 
@@ -20,10 +21,18 @@ namespace spip {
       void open (std::string, int);
 
       // send the contents of buf (bufsz bytes)
-      inline size_t send () { sendto(fd, buf, bufsz, 0, sock_addr, sock_size); };
+      inline size_t send () { return sendto(fd, buf, bufsz, 0, sock_addr, sock_size); };
 
       size_t send (size_t nbytes);
 
+      //! split each message sent by send_batch into datagrams of nbytes in
+      //! the kernel (UDP GSO), returns false if this is not supported
+      bool set_segment_size (unsigned nbytes);
+
+      //! send nmsgs messages to the destination with one sendmmsg call,
+      //! returns the number of messages sent or -1 on error
+      int send_batch (struct mmsghdr * msgs, unsigned nmsgs);
+
     private:
 
       struct sockaddr * sock_addr;
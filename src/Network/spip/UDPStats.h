@@ -9,6 +9,9 @@
 
 namespace spip {
 
+  //! Counters of one capture or transmit thread. Counters are updated with
+  //! relaxed atomics and padded to their own cache lines, so that the
+  //! stats threads can read them while the owning thread writes
   class UDPStats {
 
     public:
@@ -29,26 +32,86 @@ namespace spip {
 
       void sleeps (uint64_t nsleeps);
 
+      void received_batch (uint64_t npackets);
+
+      //! time spent waiting for the next block at a buffer boundary
+      void boundary_wait (uint64_t nanoseconds);
+
+      //! packets that arrived after their block had left the reorder window
+      void late_packets (uint64_t npackets);
+
+      //! packets beyond the reorder window, each advances the window early
+      void early_packets (uint64_t npackets);
+
+      //! record the number of reorder window blocks holding data
+      void window_used (unsigned depth);
+
       void reset ();
 
-      uint64_t get_data_transmitted () { return bytes_transmitted; };
+      uint64_t get_data_transmitted () { return load (bytes_transmitted); };
+
+      uint64_t get_data_dropped () { return load (bytes_dropped); };
+
+      uint64_t get_nsleeps() { return load (nsleeps); };
+
+      uint64_t get_npackets() { return load (npackets); };
+
+      uint64_t get_nrecv_calls() { return load (nrecv_calls); };
+
+      uint64_t get_boundary_wait () { return load (boundary_wait_ns); };
+
+      uint64_t get_late_packets () { return load (npackets_late); };
 
-      uint64_t get_data_dropped () { return bytes_dropped; };
+      uint64_t get_early_packets () { return load (npackets_early); };
 
-      uint64_t get_nsleeps() { return nsleeps; };
+      unsigned get_window_used () { return __atomic_load_n (&max_window_used, __ATOMIC_RELAXED); };
+
+      double get_packets_per_call ();
 
     private:
 
+      static inline uint64_t load (const uint64_t& counter)
+      {
+        return __atomic_load_n (&counter, __ATOMIC_RELAXED);
+      }
+
+      static inline void add (uint64_t& counter, uint64_t to_add)
+      {
+        __atomic_fetch_add (&counter, to_add, __ATOMIC_RELAXED);
+      }
+
       unsigned data;
 
       unsigned payload;
 
+      //! separates the counters from the preceding heap object
+      char pad_head[64];
+
       uint64_t bytes_transmitted;
 
       uint64_t bytes_dropped;
 
       uint64_t nsleeps;
 
+      //! packets returned by successful receive calls
+      uint64_t npackets;
+
+      //! number of successful receive calls
+      uint64_t nrecv_calls;
+
+      //! nanoseconds spent waiting at buffer boundaries
+      uint64_t boundary_wait_ns;
+
+      uint64_t npackets_late;
+
+      uint64_t npackets_early;
+
+      //! deepest reorder window block written to
+      unsigned max_window_used;
+
+      //! separates the counters from the following heap object
+      char pad_tail[64];
+
   };
 
 }
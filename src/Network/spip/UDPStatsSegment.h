@@ -0,0 +1,89 @@
+
+#ifndef __UDPStatsSegment_h
+#define __UDPStatsSegment_h
+
+#include "spip/UDPStats.h"
+
+#include <inttypes.h>
+#include <string>
+#include <vector>
+
+#define UDP_STATS_SEGMENT_MAGIC "SPIPSTAT"
+#define UDP_STATS_SEGMENT_VERSION 1
+
+// snapshots published per second by the stats threads
+#define UDP_STATS_SEGMENT_RATE 10
+
+namespace spip {
+
+  //! header of the segment, followed by one stream record per UDPStats
+  typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t nstreams;
+    //! odd while a snapshot is being written
+    uint64_t sequence;
+    //! UTC time of the last snapshot [ns]
+    uint64_t utc_ns;
+    uint64_t nsnapshots;
+    char pad[24];
+  } udp_stats_segment_header_t;
+
+  //! totals of a stream and their rates since the previous snapshot
+  typedef struct {
+    uint64_t packets;
+    uint64_t bytes;
+    uint64_t bytes_dropped;
+    uint64_t sleeps;
+    uint64_t late_packets;
+    uint64_t early_packets;
+    uint64_t recv_calls;
+    uint64_t boundary_wait_ns;
+    uint64_t window_used;
+    double bytes_per_second;
+    double bytes_dropped_per_second;
+    double packets_per_second;
+    double sleeps_per_second;
+    char pad[24];
+  } udp_stats_segment_stream_t;
+
+  //! Publishes snapshots of UDPStats to a POSIX shared memory segment, so
+  //! monitors can read live counters without touching the capture threads.
+  //! Snapshots are written under a sequence lock: readers retry if the
+  //! sequence is odd or changes while they copy the records
+  class UDPStatsSegment {
+
+    public:
+
+      //! create the segment /dev/shm/name for nstreams streams
+      UDPStatsSegment (const char * name, unsigned nstreams);
+
+      //! unlink the segment
+      ~UDPStatsSegment ();
+
+      //! publish a snapshot of each stream's stats
+      void publish (const std::vector<UDPStats *>& stats);
+
+      //! name of the segment of the data block key
+      static std::string get_name (const char * key);
+
+    private:
+
+      std::string name;
+
+      unsigned nstreams;
+
+      size_t size;
+
+      udp_stats_segment_header_t * header;
+
+      udp_stats_segment_stream_t * streams;
+
+      //! monotonic time of the previous snapshot [ns]
+      uint64_t prev_ns;
+
+  };
+
+}
+
+#endif
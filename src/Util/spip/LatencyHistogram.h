@@ -0,0 +1,102 @@
+
+#ifndef __LatencyHistogram_h
+#define __LatencyHistogram_h
+
+#include <inttypes.h>
+#include <ostream>
+
+// values below 2^(LATENCY_HISTOGRAM_SUB_BITS+1) ticks have exact buckets,
+// each higher octave is split into 2^LATENCY_HISTOGRAM_SUB_BITS buckets
+#define LATENCY_HISTOGRAM_SUB_BITS 4
+#define LATENCY_HISTOGRAM_NBUCKET ((65 - LATENCY_HISTOGRAM_SUB_BITS) << LATENCY_HISTOGRAM_SUB_BITS)
+
+namespace spip {
+
+  //! Log-bucketed histogram of intervals in ticks of the cycle counter,
+  //! in the manner of an HDR histogram: bucket widths grow with the value
+  //! so the relative resolution is constant (6% with 4 sub-bucket bits)
+  //! over the full 64-bit range. Recording is a few instructions and
+  //! never allocates. One thread records, others may read concurrently
+  class LatencyHistogram {
+
+    public:
+
+      LatencyHistogram ();
+
+      ~LatencyHistogram ();
+
+      //! record an interval [ticks]
+      void record (uint64_t ticks)
+      {
+        unsigned ibucket = get_bucket (ticks);
+        add (counts[ibucket]);
+        add (count);
+        store (sum, load (sum) + ticks);
+        if (ticks < load (min))
+          store (min, ticks);
+        if (ticks > load (max))
+          store (max, ticks);
+      }
+
+      //! record the interval since start [ticks]
+      void record_since (uint64_t start) { record (get_ticks() - start); };
+
+      //! clear the histogram, only from the recording thread
+      void reset ();
+
+      uint64_t get_count () { return load (count); };
+
+      //! interval below which the fraction of the recorded intervals lie [s]
+      double get_percentile (double fraction);
+
+      double get_min ();
+
+      double get_max ();
+
+      double get_mean ();
+
+      //! print a summary line, and the non-empty buckets if requested
+      void print (std::ostream& os, const char * name, bool buckets);
+
+      //! current value of the cycle counter
+      static uint64_t get_ticks ();
+
+      //! rate of the cycle counter, calibrated on first use
+      static double get_ticks_per_second ();
+
+      static unsigned get_bucket (uint64_t ticks)
+      {
+        if (ticks < (2 << LATENCY_HISTOGRAM_SUB_BITS))
+          return (unsigned) ticks;
+        const unsigned msb = 63 - __builtin_clzll (ticks);
+        const unsigned shift = msb - LATENCY_HISTOGRAM_SUB_BITS;
+        return ((shift + 1) << LATENCY_HISTOGRAM_SUB_BITS) + (unsigned) ((ticks >> shift) & ((1 << LATENCY_HISTOGRAM_SUB_BITS) - 1));
+      }
+
+      //! smallest interval of the bucket [ticks]
+      static uint64_t get_bucket_lower (unsigned ibucket);
+
+    private:
+
+      static uint64_t load (uint64_t& v) { return __atomic_load_n (&v, __ATOMIC_RELAXED); };
+
+      static void store (uint64_t& v, uint64_t x) { __atomic_store_n (&v, x, __ATOMIC_RELAXED); };
+
+      //! only the recording thread writes, so no read-modify-write is needed
+      static void add (uint64_t& v) { store (v, load (v) + 1); };
+
+      uint64_t counts[LATENCY_HISTOGRAM_NBUCKET];
+
+      uint64_t count;
+
+      uint64_t sum;
+
+      uint64_t min;
+
+      uint64_t max;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,80 @@
+
+#ifndef __NoiseGenerator_h
+#define __NoiseGenerator_h
+
+#include <cstddef>
+#include <inttypes.h>
+
+// independent xoshiro256+ generators advanced in lockstep by each thread
+#define NOISE_GENERATOR_NLANES 8
+
+// normal values computed together by each thread
+#define NOISE_GENERATOR_BLOCK 256
+
+namespace spip {
+
+  //! Normally distributed noise quantised to 2, 4, 8, 16 or 32 bit signed
+  //! integers. Uniform deviates come from xoshiro256+ generators that are
+  //! advanced in lockstep, and are transformed in blocks by the Box-Muller
+  //! method with polynomial log and sincos, so the loops vectorise.
+  //! Buffers are filled by several threads, each from independent streams.
+  //! 2 and 4 bit values are packed with the first value in the least
+  //! significant bits of each byte
+  class NoiseGenerator {
+
+    public:
+
+      NoiseGenerator (uint64_t seed);
+
+      ~NoiseGenerator ();
+
+      //! bits per quantised value
+      void set_nbit (unsigned nbit);
+
+      //! rms of the noise in quantisation levels, 0 for the default of nbit
+      void set_rms (double rms);
+
+      //! threads used to fill a buffer, 0 for one per online core
+      void set_nthreads (unsigned nthreads);
+
+      //! fill nbytes of buf with quantised noise
+      void fill (char * buf, size_t nbytes);
+
+      //! default rms of nbit values: 1 for 2 bit, 3 for 4 bit, otherwise 10
+      static double get_default_rms (unsigned nbit);
+
+    private:
+
+      typedef struct {
+        NoiseGenerator * obj;
+        char * buf;
+        size_t nbytes;
+        uint64_t stream;
+      } fill_thread_arg_t;
+
+      static void * fill_thread_wrapper (void * arg)
+      {
+        fill_thread_arg_t * fill_arg = (fill_thread_arg_t *) arg;
+        fill_arg->obj->fill_range (fill_arg->buf, fill_arg->nbytes, fill_arg->stream);
+        return NULL;
+      }
+
+      //! fill nbytes of buf from the generators of the stream
+      void fill_range (char * buf, size_t nbytes, uint64_t stream);
+
+      uint64_t seed;
+
+      //! number of buffers filled, so each fill draws from new streams
+      uint64_t nfills;
+
+      unsigned nbit;
+
+      double rms;
+
+      unsigned nthreads;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,91 @@
+
+#ifndef __Pacer_h
+#define __Pacer_h
+
+#include <ctime>
+#include <inttypes.h>
+
+// deadlines closer than this are spun for rather than slept for
+#define PACER_SPIN_NS 50000
+
+namespace spip {
+
+  //! Paces a stream of bytes to a rate against absolute deadlines, so
+  //! that errors in each sleep do not accumulate. The deadline of each
+  //! call is the time at which all the bytes paced so far are due. The
+  //! thread sleeps with clock_nanosleep until PACER_SPIN_NS before the
+  //! deadline, then spins. If the stream falls further behind schedule
+  //! than the maximum lag, the schedule is moved to the current time
+  //! rather than catching up in a burst
+  class Pacer {
+
+    public:
+
+      Pacer ();
+
+      ~Pacer ();
+
+      //! rate to pace to [B/s], 0 for unpaced
+      void set_rate (double bytes_per_second);
+
+      double get_rate () { return rate; };
+
+      //! largest lag behind schedule that is caught up [s]
+      void set_max_lag (double seconds);
+
+      //! start the schedule now
+      void start ();
+
+      //! start the schedule at the UTC second, which may be in the future
+      void start_at (time_t utc_second);
+
+      //! account for nbytes and wait until they are due. pace(0) waits
+      //! for the start of the schedule
+      void pace (uint64_t nbytes);
+
+      uint64_t get_bytes () { return bytes; };
+
+      //! seconds since the start of the schedule
+      double get_elapsed ();
+
+      //! bytes per second achieved since the start of the schedule
+      double get_achieved_rate ();
+
+      uint64_t get_nsleeps () { return nsleeps; };
+
+      //! number of times the schedule was moved after falling behind
+      uint64_t get_nresyncs () { return nresyncs; };
+
+      //! print the requested and achieved rates
+      void report (const char * name);
+
+      //! sleep for a relative interval of seconds
+      static void sleep (double seconds);
+
+      //! monotonic time [ns]
+      static uint64_t get_time_ns ();
+
+    private:
+
+      double rate;
+
+      uint64_t max_lag_ns;
+
+      uint64_t start_ns;
+
+      //! time and bytes at which the current schedule began
+      uint64_t base_ns;
+
+      uint64_t base_bytes;
+
+      uint64_t bytes;
+
+      uint64_t nsleeps;
+
+      uint64_t nresyncs;
+
+  };
+
+}
+
+#endif